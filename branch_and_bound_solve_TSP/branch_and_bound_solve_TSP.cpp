@@ -1,8 +1,20 @@
 #include <bits/stdc++.h>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TSP_X86_SIMD
+#include <immintrin.h>
+#endif
 using namespace std;
 const int N = 55;
 int n, m;
 
+// ڽӾÿ䵽 LD  int  32 ֽڶ룬ȱߡԽλΪ INF
+const int LD = 64;
+const int INF = 0x3f3f3f3f;
+static_assert(N <= LD, "visited set must fit in a 64-bit mask");
+alignas(32) int dist[N][LD];
+int cols;             // ʵʲȡ 8
+uint64_t all_mask;    //  1..n Ӧλ
+
 // ȶ Eȷʹʱ
 struct E {
     int from, to, w;
@@ -11,37 +23,272 @@ struct E {
     bool operator == (const E& b) const { return w == b.w; }
 };
 
-template<class T>
-class deletable_heap {
-    priority_queue<T> origin_heap;
-    priority_queue<T> delete_heap;
-public:
-    void push(T item) { origin_heap.push(item); }
-    void del(T item) { delete_heap.push(item); }
-    T get() {
-        while (!origin_heap.empty() && !delete_heap.empty() &&
-            origin_heap.top() == delete_heap.top()) {
-            origin_heap.pop(), delete_heap.pop();
-        }
-        return origin_heap.top();
-    }
-};
-
 struct node {
     int pos, w, est, rest_nodes_num;
     vector<int> route;
-    deletable_heap<E> dh;
-    node(int p, int weight, int estimate, deletable_heap<E> heap, int rest, vector<int> route)
-        : pos(p), w(weight), est(estimate), dh(heap), rest_nodes_num(rest), route(route) {}
+    uint64_t vis;  // ѷʶλ
+    node(int p, int weight, int estimate, uint64_t visited, int rest, vector<int> route)
+        : pos(p), w(weight), est(estimate), rest_nodes_num(rest), route(route), vis(visited) {}
     bool operator < (const node& b) const { return est > b.est; }
 };
 
+// ɱȶУдʱֱӶȡײ
+struct frontier : priority_queue<node> {
+    const vector<node>& items() const { return c; }
+};
+
+//  mask ѡеСֵԼССֵûпѡʱΪ INF
+int row_min_scalar(const int* row, uint64_t mask)
+{
+    int r = INF;
+    for (; mask; mask &= mask - 1) r = min(r, row[__builtin_ctzll(mask)]);
+    return r;
+}
+
+pair<int, int> row_min2_scalar(const int* row, uint64_t mask)
+{
+    int a = INF, b = INF;
+    for (; mask; mask &= mask - 1) {
+        int x = row[__builtin_ctzll(mask)];
+        if (x < a) b = a, a = x;
+        else if (x < b) b = x;
+    }
+    return { a, b };
+}
+
+#ifdef TSP_X86_SIMD
+//  mask дӵ j λʼ 8 λչÿ int ͨȫ 1 / ȫ 0
+__attribute__((target("avx2")))
+static inline __m256i lane_mask_avx2(uint64_t mask, int j)
+{
+    const __m256i bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    __m256i sel = _mm256_and_si256(_mm256_set1_epi32((int)(mask >> j) & 0xff), bits);
+    return _mm256_cmpeq_epi32(sel, bits);
+}
+
+__attribute__((target("avx2")))
+int row_min_avx2(const int* row, uint64_t mask)
+{
+    const __m256i inf = _mm256_set1_epi32(INF);
+    __m256i r = inf;
+    for (int j = 0; j < cols; j += 8) {
+        __m256i x = _mm256_load_si256((const __m256i*)(row + j));
+        r = _mm256_min_epi32(r, _mm256_blendv_epi8(inf, x, lane_mask_avx2(mask, j)));
+    }
+    __m128i h = _mm_min_epi32(_mm256_castsi256_si128(r), _mm256_extracti128_si256(r, 1));
+    h = _mm_min_epi32(h, _mm_shuffle_epi32(h, _MM_SHUFFLE(1, 0, 3, 2)));
+    h = _mm_min_epi32(h, _mm_shuffle_epi32(h, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(h);
+}
+
+__attribute__((target("avx2")))
+pair<int, int> row_min2_avx2(const int* row, uint64_t mask)
+{
+    const __m256i inf = _mm256_set1_epi32(INF);
+    __m256i m1 = inf, m2 = inf;
+    for (int j = 0; j < cols; j += 8) {
+        __m256i x = _mm256_load_si256((const __m256i*)(row + j));
+        x = _mm256_blendv_epi8(inf, x, lane_mask_avx2(mask, j));
+        m2 = _mm256_min_epi32(m2, _mm256_max_epi32(m1, x));
+        m1 = _mm256_min_epi32(m1, x);
+    }
+    alignas(32) int lanes[16];
+    _mm256_store_si256((__m256i*)lanes, m1);
+    _mm256_store_si256((__m256i*)(lanes + 8), m2);
+    return row_min2_scalar(lanes, 0xffff);
+}
+
+__attribute__((target("sse4.1")))
+static inline __m128i lane_mask_sse(uint64_t mask, int j)
+{
+    const __m128i bits = _mm_setr_epi32(1, 2, 4, 8);
+    __m128i sel = _mm_and_si128(_mm_set1_epi32((int)(mask >> j) & 0xf), bits);
+    return _mm_cmpeq_epi32(sel, bits);
+}
+
+__attribute__((target("sse4.1")))
+int row_min_sse(const int* row, uint64_t mask)
+{
+    const __m128i inf = _mm_set1_epi32(INF);
+    __m128i r = inf;
+    for (int j = 0; j < cols; j += 4) {
+        __m128i x = _mm_load_si128((const __m128i*)(row + j));
+        r = _mm_min_epi32(r, _mm_blendv_epi8(inf, x, lane_mask_sse(mask, j)));
+    }
+    r = _mm_min_epi32(r, _mm_shuffle_epi32(r, _MM_SHUFFLE(1, 0, 3, 2)));
+    r = _mm_min_epi32(r, _mm_shuffle_epi32(r, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(r);
+}
+
+__attribute__((target("sse4.1")))
+pair<int, int> row_min2_sse(const int* row, uint64_t mask)
+{
+    const __m128i inf = _mm_set1_epi32(INF);
+    __m128i m1 = inf, m2 = inf;
+    for (int j = 0; j < cols; j += 4) {
+        __m128i x = _mm_load_si128((const __m128i*)(row + j));
+        x = _mm_blendv_epi8(inf, x, lane_mask_sse(mask, j));
+        m2 = _mm_min_epi32(m2, _mm_max_epi32(m1, x));
+        m1 = _mm_min_epi32(m1, x);
+    }
+    alignas(16) int lanes[8];
+    _mm_store_si128((__m128i*)lanes, m1);
+    _mm_store_si128((__m128i*)(lanes + 4), m2);
+    return row_min2_scalar(lanes, 0xff);
+}
+#endif
+
+int (*row_min)(const int*, uint64_t) = row_min_scalar;
+pair<int, int> (*row_min2)(const int*, uint64_t) = row_min2_scalar;
+
+// ʱ CPUѡõʵ
+void select_kernels()
+{
+#ifdef TSP_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        row_min = row_min_avx2, row_min2 = row_min2_avx2;
+    else if (__builtin_cpu_supports("sse4.1"))
+        row_min = row_min_sse, row_min2 = row_min2_sse;
+#endif
+}
+
+//  pos ߱δʶٻص 1 ʣ·½磬޷ʱ INF
+// ȡ½ĽϴߣÿС֮ͣÿ̹֮͵һ롣
+long long bound(int pos, uint64_t vis)
+{
+    uint64_t rest = all_mask & ~vis;
+    if (!rest) return dist[pos][1];
+    // ֻʣһҴ 1 ʱ߶ 1ûдСһ˵
+    if (pos == 1 && !(rest & (rest - 1))) {
+        int d = dist[1][__builtin_ctzll(rest)];
+        return d >= INF ? INF : 2LL * d;
+    }
+    long long out = row_min(dist[pos], rest);
+    long long twice = out + row_min(dist[1], rest);
+    if (out >= INF || twice - out >= INF) return INF;
+    for (uint64_t s = rest; s; s &= s - 1) {
+        const int* row = dist[__builtin_ctzll(s)];
+        int nxt = row_min(row, rest | 1ULL << 1);
+        auto two = row_min2(row, rest | 1ULL << 1 | 1ULL << pos);
+        if (nxt >= INF || two.second >= INF) return INF;
+        out += nxt;
+        twice += two.first + two.second;
+    }
+    return max(out, (twice + 1) / 2);
+}
+
 vector<E> edge[N];
-priority_queue<node> q;
-deletable_heap<E> dh;
-bool check(const vector<int>& route, int nxt, int rest_num)
+frontier q;
+bool sign = false;
+long long expanded = 0;  // չĽ
+
+// 㣺ڰǰд̣--resume ʱлָ
+string ckpt_file;
+long long ckpt_every = 10000;
+const char CKPT_MAGIC[8] = { 'T', 'S', 'P', 'C', 'K', 'P', 'T', '3' };
+uint64_t graph_hash = 14695981039346656037ULL;  // ˳ (a, b, w)  FNV-1a ָ
+
+void hash_edge(int a, int b, int w)
 {
-    if (find(route.begin(), route.end(), nxt) == route.end())
+    for (int32_t x : { a, b, w })
+        for (int k = 0; k < 4; k++)
+            graph_hash = (graph_hash ^ (uint8_t)(x >> (8 * k))) * 1099511628211ULL;
+}
+
+template<class T> void put_raw(ostream& os, T x) { os.write((const char*)&x, sizeof(x)); }
+template<class T> T get_raw(istream& is) { T x{}; is.read((char*)&x, sizeof(x)); return x; }
+
+// ÿֻ·λڶȡʱ·ؽ
+bool save_checkpoint(const string& file)
+{
+    string tmp = file + ".tmp";
+    ofstream os(tmp, ios::binary);
+    if (!os) return false;
+    os.write(CKPT_MAGIC, sizeof(CKPT_MAGIC));
+    put_raw<int32_t>(os, n), put_raw<int32_t>(os, m);
+    put_raw<uint64_t>(os, graph_hash);
+    put_raw<int32_t>(os, sign);
+    put_raw<int64_t>(os, expanded);
+    put_raw<int64_t>(os, q.size());
+    for (const auto& u : q.items()) {
+        put_raw<int32_t>(os, u.pos), put_raw<int32_t>(os, u.w);
+        put_raw<int32_t>(os, u.est), put_raw<int32_t>(os, u.rest_nodes_num);
+        put_raw<int32_t>(os, u.route.size());
+        for (int x : u.route) put_raw<int32_t>(os, x);
+    }
+    os.close();
+    if (!os) return false;
+    // дʱļٸ;˳𻵵ļ
+    if (rename(tmp.c_str(), file.c_str()) != 0) {
+        remove(file.c_str());
+        if (rename(tmp.c_str(), file.c_str()) != 0) return false;
+    }
+    return true;
+}
+
+bool load_checkpoint(const string& file)
+{
+    ifstream is(file, ios::binary);
+    char magic[sizeof(CKPT_MAGIC)];
+    if (!is.read(magic, sizeof(magic)) || !equal(magic, magic + sizeof(magic), CKPT_MAGIC)) {
+        cerr << "not a checkpoint file: " << file << endl;
+        return false;
+    }
+    int cn = get_raw<int32_t>(is), cm = get_raw<int32_t>(is);
+    uint64_t ch = get_raw<uint64_t>(is);
+    if (cn != n || cm != m || ch != graph_hash) {
+        cerr << "checkpoint was written for a different graph" << endl;
+        return false;
+    }
+    sign = get_raw<int32_t>(is);
+    expanded = get_raw<int64_t>(is);
+    long long cnt = get_raw<int64_t>(is);
+    // ÿռ 6  int32ܳļʣಿɵ
+    auto here = is.tellg();
+    is.seekg(0, ios::end);
+    long long left = is.tellg() - here;
+    is.seekg(here);
+    if (is && (cnt < 0 || cnt > left / (6 * 4))) {
+        cerr << "checkpoint file is corrupted: " << file << endl;
+        return false;
+    }
+    for (long long i = 0; i < cnt && is; i++) {
+        int pos = get_raw<int32_t>(is), w = get_raw<int32_t>(is);
+        int est = get_raw<int32_t>(is), rest = get_raw<int32_t>(is);
+        int len = get_raw<int32_t>(is);
+        bool ok = is && 1 <= pos && pos <= n && 0 < len && len <= n + 1 && rest == n + 1 - len;
+        vector<int> route(ok ? len : 0);
+        uint64_t vis = 0;
+        for (auto& x : route) {
+            x = get_raw<int32_t>(is);
+            if (x < 1 || x > n) { ok = false; break; }
+            vis |= 1ULL << x;
+        }
+        if (!is) break;
+        // · 1 ; 1 ҲظֻȫĻ· 1 β
+        bool closed = ok && len == n + 1;
+        for (int j = 1; ok && j < len; j++)
+            if ((route[j] == 1) != (closed && j == len - 1)) ok = false;
+        ok = ok && route[0] == 1 && route.back() == pos && (vis >> 1 & 1) &&
+            __builtin_popcountll(vis) == len - closed;
+        // Ȩֵ·½һ
+        long long rest_est = (!ok || closed) ? 0 : bound(pos, vis);
+        if (!ok || w < 0 || rest_est >= INF || est != w + rest_est) {
+            cerr << "checkpoint file is corrupted: " << file << endl;
+            return false;
+        }
+        q.push(node{ pos, w, est, vis, rest, route });
+    }
+    if (!is) {
+        cerr << "checkpoint file is truncated: " << file << endl;
+        return false;
+    }
+    return true;
+}
+bool check(uint64_t vis, int nxt, int rest_num)
+{
+    if (!(vis >> nxt & 1))
         return true;
     else if (nxt == 1 && rest_num == 1)
         return true;
@@ -58,16 +305,26 @@ void print_route(const vector<int>& route)
     cout << endl;
 }
 
-int bfs() {
-    q.push(node(1, 0, n * dh.get().w, dh, n, {1}));  // ע˳
-    bool sign = false;
+int bfs(bool resumed) {
+    if (!resumed) {
+        long long est = bound(1, 1ULL << 1);
+        if (est >= INF) return -1;
+        q.push(node(1, 0, est, 1ULL << 1, n, {1}));  // ע˳
+    }
+    long long last_ckpt = expanded;
     while (!q.empty()) {
+        if (!ckpt_file.empty() && expanded - last_ckpt >= ckpt_every) {
+            if (!save_checkpoint(ckpt_file))
+                cerr << "failed to write checkpoint " << ckpt_file << endl;
+            last_ckpt = expanded;
+        }
         auto u = q.top();
         q.pop();
+        expanded++;
         int pos = u.pos;
         int w = u.w;
         int rest_num = u.rest_nodes_num;
-        auto current_dh = u.dh;  // ͻ
+        auto vis = u.vis;
         auto route = u.route;
         cout << "current node:" << pos << " sum:" << w << " rest_num:" << rest_num << endl;
         // cout << fa << "-->" << pos << "sum:" << w << endl;
@@ -80,31 +337,51 @@ int bfs() {
         else if (pos == 1) sign = true;
         for (auto e : edge[pos]) {
             int to = e.to, val = e.w;
-            if (!check(route, to, rest_num)) continue;
-            auto tmp = current_dh;
-            tmp.del(E{ pos, to, val });
-            tmp.del(E{ to, pos, val });
-            int min_w = tmp.get().w;
-            int new_est = min_w * (rest_num - 1) + val + w;
+            if (!check(vis, to, rest_num)) continue;
+            auto new_vis = vis | 1ULL << to;
+            long long rest_est = (to == 1) ? 0 : bound(to, new_vis);
+            if (rest_est >= INF) continue;  // ʣඥ޷ɻ·
+            int new_est = rest_est + val + w;
             auto new_route = route;
             new_route.push_back(to);
-            q.push(node{ to, w + val, new_est, tmp, rest_num - 1, new_route});
+            q.push(node{ to, w + val, new_est, new_vis, rest_num - 1, new_route});
             cout << pos << "-->" << to << " sum:" << w + val << endl;
         }
     }
     return -1;  // δҵ·
 }
 
-int main() {
+// ÷: tsp [--checkpoint ļ] [--checkpoint-every ] [--resume ļ] [--no-simd] < 
+int main(int argc, char* argv[]) {
+    string resume_file;
+    bool simd = true;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 < argc && arg == "--checkpoint") ckpt_file = argv[++i];
+        else if (i + 1 < argc && arg == "--checkpoint-every") ckpt_every = max(atoll(argv[++i]), 1LL);
+        else if (i + 1 < argc && arg == "--resume") resume_file = argv[++i];
+        else if (arg == "--no-simd") simd = false;
+        else {
+            cerr << "usage: " << argv[0]
+                << " [--checkpoint file] [--checkpoint-every nodes] [--resume file] [--no-simd] < graph" << endl;
+            return 1;
+        }
+    }
+    if (!resume_file.empty() && ckpt_file.empty()) ckpt_file = resume_file;
+    if (simd) select_kernels();
     cin >> n >> m;
+    memset(dist, 0x3f, sizeof(dist));
+    cols = (n + 1 + 7) / 8 * 8;
+    all_mask = (1ULL << (n + 1)) - 2;
     for (int i = 1; i <= m; i++) {
         int a, b, w; cin >> a >> b >> w;
         edge[a].push_back({ a, b, w });
         edge[b].push_back({ b, a, w });
-        dh.push({ a, b, w });
-        dh.push({ b, a, w });
+        if (a != b) dist[a][b] = dist[b][a] = min(dist[a][b], w);
+        hash_edge(a, b, w);
     }
-    cout << bfs() << endl;
+    if (!resume_file.empty() && !load_checkpoint(resume_file)) return 1;
+    cout << bfs(!resume_file.empty()) << endl;
     return 0;
 }
 /*
@@ -118,4 +395,8 @@ int main() {
 2 5 1
 2 4 1
 
+2 2
+1 2 5
+1 2 6
+
 */
\ No newline at end of file